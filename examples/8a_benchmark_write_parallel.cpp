@@ -23,9 +23,9 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
-#include <random>
 #include <vector>
 #include <fstream>
 #include <ostream>
@@ -36,6 +36,15 @@
 #   include <adios2.h>
 #endif
 
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#endif
+
+#if defined(__linux)
+#   include <cstdlib>
+#   include <sys/mman.h>
+#endif
+
 using std::cout;
 using namespace openPMD;
 
@@ -150,32 +159,160 @@ private:
 };
 
 
-/**     createData
- *      generate a shared ptr of given size  with given type & default value
- *
- * @param T             data type
- * @param size          data size
- * @param val           data value by default
- * @param increment     data increment by linear with index
+/** The DataArena class backing createData()
  *
+ *  Recycles the block buffers of a step for the following steps,
+ *  instead of a new/delete pair per block per step.
+ *  Slabs are stable in memory until reset(), so handed-out pointers
+ *  stay valid for the backend until the iteration is flushed.
  */
+class DataArena
+{
+public:
+  /** hand out nBytes of scratch memory
+   *
+   * @param nBytes   requested block size in bytes
+   */
+  void* alloc(unsigned long nBytes)
+  {
+    // keep blocks cache-line aligned
+    nBytes = (nBytes + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+    while ( m_CurrSlab < m_Slabs.size() )
+      {
+    if ( m_SlabFill + nBytes <= m_SlabSizes[m_CurrSlab] ) {
+      auto p = m_Slabs[m_CurrSlab].get() + m_SlabFill;
+      m_SlabFill += nBytes;
+      return p;
+    }
+    m_CurrSlab ++;
+    m_SlabFill = 0;
+      }
+
+    auto slabSize = std::max(nBytes, m_MinSlabBytes);
+    // full huge pages only
+    slabSize = (slabSize + m_HugePageBytes - 1) / m_HugePageBytes * m_HugePageBytes;
+    m_Slabs.emplace_back(allocSlab(slabSize), &DataArena::freeSlab);
+    m_SlabSizes.push_back(slabSize);
+    m_SlabFill = nBytes;
+    return m_Slabs.back().get();
+  }
+
+  /** recycle all slabs
+   *
+   *  only safe after the consuming iteration has been flushed
+   */
+  void reset()
+  {
+    m_CurrSlab = 0;
+    m_SlabFill = 0;
+  }
 
+private:
+  /** slab memory, 2 MiB aligned + THP hinted
+   *
+   *  every storeChunk hand-off walks these pages again in the backend,
+   *  huge pages keep the TLB out of the way on multi-GB steps
+   */
+  static uint8_t* allocSlab(unsigned long nBytes)
+  {
+#if defined(__linux)
+    void* p = nullptr;
+    if ( posix_memalign(&p, m_HugePageBytes, nBytes) != 0 )
+      throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    madvise(p, nBytes, MADV_HUGEPAGE);  // best effort
+#endif
+#ifdef MADV_DONTFORK
+    madvise(p, nBytes, MADV_DONTFORK);  // MPI helpers may fork()
+#endif
+    return static_cast<uint8_t*>(p);
+#else
+    return new uint8_t[nBytes];
+#endif
+  }
+
+  static void freeSlab(uint8_t* p)
+  {
+#if defined(__linux)
+    free(p);
+#else
+    delete[] p;
+#endif
+  }
+
+  std::vector<std::unique_ptr<uint8_t, void(*)(uint8_t*)>> m_Slabs;
+  std::vector<unsigned long> m_SlabSizes;
+  unsigned long m_CurrSlab = 0;
+  unsigned long m_SlabFill = 0;
+
+  static constexpr unsigned long m_Alignment = 64ul;
+  static constexpr unsigned long m_HugePageBytes = 2ul * 1048576ul;
+  static constexpr unsigned long m_MinSlabBytes = 16ul * 1048576ul;
+};
+
+/* double buffering: the arena of step N-1 stays untouched while step N
+ * fills the other one, so an engine draining the previous step
+ * asynchronously never races the next fill. store() flips the pair.
+ */
+static DataArena g_DataArenas[2];
+static DataArena* g_CurrArena = &g_DataArenas[0];
+
+/**     fillSeries
+ *      fill a buffer with the series  val, val+increment, ...
+ *
+ * @param p             target buffer
+ * @param n             num of elements
+ * @param val           start value
+ * @param increment     increment btw elements
+ *
+ */
 template<typename T>
-std::shared_ptr< T > createData(const unsigned long& size,  const T& val, const T& increment)
+void fillSeries(T* p, unsigned long n, T val, T increment)
   {
-    auto E = std::shared_ptr< T > {
-      new T[size], []( T * d ) {delete[] d;}
-    };
+    for(unsigned long  i = 0ul; i < n; i++ )
+      p[i] = val+i*increment;
+  }
 
-    for(unsigned long  i = 0ul; i < size; i++ )
+/** overload for the particle id pattern  offset, offset+1, ...
+ *
+ *  vectorized by hand (4 ids per step with AVX2),
+ *  the shared_ptr aliasing in the generic loop defeats auto-vectorization
+ */
+void fillSeries(uint64_t* p, unsigned long n, uint64_t val, uint64_t increment)
+  {
+    unsigned long i = 0ul;
+#if defined(__AVX2__)
+    if (1ul == increment)
       {
-    if (increment != 0)
-      //E.get()[i] = val+i;
-      E.get()[i] = val+i*increment;
-    else
-      E.get()[i] = val;
+    __m256i base = _mm256_set1_epi64x( static_cast<long long>(val) );
+    __m256i idx  = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i four = _mm256_set1_epi64x(4);
+    for ( ; i + 4ul <= n; i += 4ul )
+      {
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>(p + i),
+                 _mm256_add_epi64(base, idx) );
+        idx = _mm256_add_epi64(idx, four);
       }
-    return E;
+      }
+#endif
+    for ( ; i < n; i++ )
+      p[i] = val+i*increment;
+  }
+
+/**     viewOf
+ *      wrap an arena pointer for storeChunk hand-off
+ *      the aliasing constructor on an empty shared_ptr carries no
+ *      control block: no allocation, no atomic refcounts, no deleter
+ *
+ * @param T             data type
+ * @param p             pointer into the step arena
+ *
+ */
+template<typename T>
+std::shared_ptr< T > viewOf(T* p)
+  {
+    return std::shared_ptr< T >( std::shared_ptr< T >(), p );
   }
 
 /** Find supported backends
@@ -214,12 +351,16 @@ public:
   unsigned long getTotalNumParticles();
   void run();
   void store(Series& series, int step);
-  void storeMesh(Series& series, int step, const std::string& fieldName, const std::string& compName);
+  void storeMesh(MeshRecordComponent& compA, int step);
+  template<typename T>
+  void storeMeshData(MeshRecordComponent& compA, int step);
   void storeParticles( ParticleSpecies& currSpecies,  int& step );
 
   unsigned long countMe(const Extent& count);
   unsigned long indexMe(const Offset& count);
 
+  void mergeBlocks();
+
   Extent m_GlobalMesh;
   Extent m_MinBlock;
   const TestInput& m_Input;
@@ -227,6 +368,33 @@ public:
   Extent m_GlobalUnitMesh;
   std::vector<std::pair<Offset, Extent>> m_InRankMeshLayout;
 
+  /* dataset descriptors are identical across steps (global mesh and
+   * total particle count are fixed per run); built once in run()
+   * instead of re-running determineDatatype + an Extent copy per
+   * component and step  */
+  std::unique_ptr<Dataset> m_MeshDataset;
+  std::unique_ptr<Dataset> m_ParticleIntDataset;
+  std::unique_ptr<Dataset> m_ParticleRealDataset;
+
+  /* in-rank particle layout, SoA:
+   *   parallel offset/count columns give unit-stride access
+   *   in the hot storeChunk loops (16B pairs forced strided loads)
+   */
+  struct ParticleLayout
+  {
+    std::vector<unsigned long> m_Offsets;
+    std::vector<unsigned long> m_Counts;
+
+    unsigned long size() const { return m_Counts.size(); }
+    void clear() { m_Offsets.clear(); m_Counts.clear(); }
+    void add(unsigned long offset, unsigned long count)
+    {
+      m_Offsets.push_back(offset);
+      m_Counts.push_back(count);
+    }
+  };
+  ParticleLayout m_InRankParticleLayout;
+
   void PrintMe();
 };  // class Abstractpatter
 
@@ -241,9 +409,7 @@ class OneDimPattern: public AbstractPattern
 public:
   OneDimPattern(const TestInput& input);
   bool setLayOut(int step) override;
-  unsigned long  getNthMeshExtent( unsigned int n, Offset& offset, Extent& count );
   void getNthParticleExtent( unsigned int n, unsigned long& offset, unsigned long& count ) override;
-  unsigned int getNumBlocks();
 };
 
 /*
@@ -260,9 +426,6 @@ public:
   void coordinate(unsigned long idx, const Extent& grid, Offset& o);
 
   Extent m_PatchUnitMesh; // based on m_GlobalUnitMesh
-
-
-  std::vector<std::pair<unsigned long, unsigned long>> m_InRankParticleLayout;
 };
 
 /*
@@ -279,8 +442,6 @@ public:
   void coordinate(unsigned long idx, const Extent& grid, Offset& o);
 
   Extent m_PatchUnitMesh; // based on m_GlobalUnitMesh
-
-  std::vector<std::pair<unsigned long, unsigned long>> m_InRankParticleLayout;
 };
 
 
@@ -308,8 +469,56 @@ public:
   }
 
 
+  /** alignToStripe()
+   * pads the minimal block along the contiguous (=last) dimension
+   * to a multiple of the filesystem stripe size, so storeChunk
+   * boundaries do not shear stripes (=lock contention on Lustre).
+   *
+   * opt-in via OPENPMD_LUSTRE_STRIPE_BYTES; without it only a hint
+   * is printed at rank 0 when blocks are misaligned w.r.t. 1 MiB.
+   */
+  void alignToStripe()
+  {
+    auto const stripeStr = auxiliary::getEnvString( "OPENPMD_LUSTRE_STRIPE_BYTES", "" );
+
+    unsigned long stripeBytes = 1048576ul;
+    if ( stripeStr.size() > 0 )
+      stripeBytes = strtoul( stripeStr.c_str(), nullptr, 0 );
+    if ( 0 == stripeBytes )
+      return;
+
+    unsigned long* lastBulk = &m_XBulk;
+    if ( 2 == m_Dim )
+      lastBulk = &m_YBulk;
+    else if ( 3 == m_Dim )
+      lastBulk = &m_ZBulk;
+
+    // element size follows the configured precision (float by default)
+    auto const elemBytes = m_DoubleMesh ? sizeof(double) : sizeof(float);
+    auto const elemsPerStripe = stripeBytes / elemBytes;
+    auto const rem = (*lastBulk) % elemsPerStripe;
+    if ( 0 == rem )
+      return;
+
+    if ( stripeStr.size() > 0 ) {
+      *lastBulk += elemsPerStripe - rem;
+      if ( 0 == m_MPIRank )
+    std::cout<<"Padded min block to "<<*lastBulk
+         <<" elements to match stripe size "<<stripeBytes<<" bytes"<<std::endl;
+    } else if ( 0 == m_MPIRank ) {
+      std::cout<<"Hint: min block ends at "<<(*lastBulk) * elemBytes
+           <<" bytes, not a stripe multiple."
+           <<" Set OPENPMD_LUSTRE_STRIPE_BYTES to pad."<<std::endl;
+    }
+  }
+
   int m_MPISize = 1; //!< MPI size
   int m_MPIRank = 0; //!< MPI rank
+  MPI_Comm m_IOComm = MPI_COMM_WORLD; //!< ranks reordered by file offset
+  MPI_Comm m_NodeComm = MPI_COMM_NULL; //!< MPI-3 shared-memory (=per node) ranks
+  int m_NodeSize = 1; //!< ranks on this node
+  int m_NodeRank = 0; //!< rank within the node
+  int m_NumNodes = 1; //!< number of nodes in the job
   unsigned long m_XBulk = 64ul; //!< min num of elements at X dimension
   unsigned long m_YBulk = 32ul;  //!< min num of elements at Y dimension
   unsigned long m_ZBulk = 32ul;
@@ -324,6 +533,7 @@ public:
   bool m_Unbalance = false;      //! load is different among processors
 
   int m_Ratio = 1; //! particle:mesh ratio
+  bool m_DoubleMesh = false; //! mesh data as double, default is float (half the I/O bytes)
   unsigned long  m_XFactor = 0; // if not overwritten, use m_MPISize
   unsigned long  m_YFactor = 8;
   unsigned long  m_ZFactor = 8;
@@ -369,6 +579,12 @@ void parse(TestInput& input, std::string line)
     return;
   }
 
+  if ( vec[0].compare("meshPrecision") == 0 ) {
+    if ( vec[1].compare("double") == 0 )
+      input.m_DoubleMesh = true;
+    return;
+  }
+
   if ( vec[0].compare("rankBlocks") == 0 ) {
     if ( vec[1].compare("false") == 0 )
       input.m_Seg = 10;
@@ -484,6 +700,28 @@ main( int argc, char *argv[] )
     MPI_Comm_size( MPI_COMM_WORLD, &input.m_MPISize );
     MPI_Comm_rank( MPI_COMM_WORLD, &input.m_MPIRank );
 
+    /* all I/O below goes through a communicator whose ranks are ordered
+     * by the file offsets they will write: block offsets grow monotonically
+     * with the rank id, so the id doubles as the split key. Launchers that
+     * hand out non-packed mappings thus still aggregate neighbouring
+     * offsets on neighbouring ranks.
+     */
+    MPI_Comm_split( MPI_COMM_WORLD, 0, input.m_MPIRank, &input.m_IOComm );
+    MPI_Comm_size( input.m_IOComm, &input.m_MPISize );
+    MPI_Comm_rank( input.m_IOComm, &input.m_MPIRank );
+
+    /* per-node view of the job: node-local metadata stays on shared
+     * memory, only node leaders need to cross the NIC. Used to size
+     * one I/O aggregator per node.
+     */
+    MPI_Comm_split_type( input.m_IOComm, MPI_COMM_TYPE_SHARED, input.m_MPIRank,
+             MPI_INFO_NULL, &input.m_NodeComm );
+    MPI_Comm_size( input.m_NodeComm, &input.m_NodeSize );
+    MPI_Comm_rank( input.m_NodeComm, &input.m_NodeRank );
+
+    int leader = (0 == input.m_NodeRank) ? 1 : 0;
+    MPI_Allreduce( &leader, &input.m_NumNodes, 1, MPI_INT, MPI_SUM, input.m_IOComm );
+
     int dataDim = parseArgs(argc, argv, input);
     if ( ( dataDim <= 0 ) || ( dataDim > 3 ) ) {
       if ( 0 == input.m_MPIRank)
@@ -496,6 +734,8 @@ main( int argc, char *argv[] )
     if ( 0 == input.m_XFactor )
       input.m_XFactor = input.m_MPISize;
 
+    input.alignToStripe();
+
     auto const backends = getBackends();
 
     try {
@@ -519,6 +759,8 @@ main( int argc, char *argv[] )
       if (0 == input.m_MPIRank) std::cout<<"Error: "<<ex.what()<<std::endl;
     }
 
+    MPI_Comm_free( &input.m_NodeComm );
+    MPI_Comm_free( &input.m_IOComm );
     MPI_Finalize();
 
     return 0;
@@ -545,6 +787,16 @@ void AbstractPattern::run()
     if (m_Input.m_Unbalance)
       balance="u";
 
+    m_MeshDataset.reset( new Dataset(
+        m_Input.m_DoubleMesh ? determineDatatype< double >()
+                             : determineDatatype< float >(),
+        m_GlobalMesh ) );
+    auto const np = getTotalNumParticles();
+    m_ParticleIntDataset.reset(
+        new Dataset( determineDatatype< uint64_t >(), {np} ) );
+    m_ParticleRealDataset.reset(
+        new Dataset( determineDatatype< double >(), {np} ) );
+
     { // file based
       std::ostringstream s;
       s << "../samples/8a_parallel_"<<m_GlobalMesh.size()<<"D"<<balance<<"_%07T"<<m_Input.m_Backend;
@@ -555,11 +807,26 @@ void AbstractPattern::run()
         std::string tag = "Writing: "+filename ;
         Timer kk(tag.c_str(), m_Input.m_MPIRank);
 
+        // one substream (=aggregator) per node: intra-node traffic stays
+        // on shared memory, only node leaders write towards the filesystem
+        std::string options = "{}";
+        if ( m_Input.m_Backend == ".bp" && m_Input.m_NumNodes > 0 )
+        {
+            std::ostringstream json;
+            json << "{ \"adios2\": { \"engine\": { \"type\": \"bp4\", "
+                 << "\"parameters\": { \"SubStreams\": \""
+                 << m_Input.m_NumNodes << "\" } } } }";
+            options = json.str();
+        }
+
+        // %07T in the file name produces one file per step,
+        // so the series (and its collective open) is reused across steps
+        Series series = Series(filename, Access::CREATE, m_Input.m_IOComm, options);
+        series.setMeshesPath( "fields" );
+
         for( int step = 1; step <= m_Input.m_Steps; step++ )
         {
             setLayOut(step);
-            Series series = Series(filename, Access::CREATE, MPI_COMM_WORLD);
-            series.setMeshesPath( "fields" );
             store(series, step);
         }
       }
@@ -575,7 +842,7 @@ void AbstractPattern::run()
         std::string tag = "Writing: "+filename ;
         Timer kk(tag.c_str(), m_Input.m_MPIRank);
 
-        Series series = Series(filename, Access::CREATE, MPI_COMM_WORLD);
+        Series series = Series(filename, Access::CREATE, m_Input.m_IOComm);
         series.setMeshesPath( "fields" );
 
         for( int step = 1; step <= m_Input.m_Steps; step++ ) {
@@ -597,57 +864,88 @@ void AbstractPattern::run()
    */
 void AbstractPattern::store(Series& series, int step)
   {
+    // flip to this step's arena; its previous occupant (step-2) is
+    // long flushed, while the other arena still backs step-1
+    g_CurrArena = &g_DataArenas[step & 1];
+    g_CurrArena->reset();
+
+    // resolve each map lookup once; iterations/meshes are tree-backed
+    // containers with string keys, not free per-call accesses
+    Iteration& currIt = series.iterations[step];
+
     std::string components[] = {"x", "y", "z"};
-    std::string fieldName1 = "E";
-    std::string fieldName2 = "B";
+    Mesh& fieldE = currIt.meshes["E"];
+    Mesh& fieldB = currIt.meshes["B"];
     for (unsigned int i=0; i<m_GlobalMesh.size(); i++)
     {
-      storeMesh(series, step, fieldName1, components[i]);
-      storeMesh(series, step, fieldName2, components[i]);
+      storeMesh(fieldE[components[i]], step);
+      storeMesh(fieldB[components[i]], step);
     }
 
-    std::string field_rho = "rho";
-    std::string scalar = openPMD::MeshRecordComponent::SCALAR;
-    storeMesh(series, step, field_rho, scalar);
+    Mesh& fieldRho = currIt.meshes["rho"];
+    storeMesh(fieldRho[openPMD::MeshRecordComponent::SCALAR], step);
 
-    ParticleSpecies& currSpecies = series.iterations[step].particles["ion"];
+    ParticleSpecies& currSpecies = currIt.particles["ion"];
     storeParticles(currSpecies, step);
 
-    series.iterations[step].close();
+    currIt.close();
   }
 
 
   /*
    * Write meshes
    *
-   *  @param series     Input, openPMD series
+   *  @param compA      Input, mesh component to write
    *  @param step       Input, iteration step
-   *  @param fieldName  Input, mesh name
-   *  @param compName   Input, component of mesh
    *
    */
   void
-  AbstractPattern::storeMesh(Series& series, int step, const std::string& fieldName, const std::string& compName)
+  AbstractPattern::storeMesh(MeshRecordComponent& compA, int step)
   {
-    MeshRecordComponent compA = series.iterations[step].meshes[fieldName][compName];
-
-    Datatype datatype = determineDatatype< double >();
-    Dataset dataset = Dataset( datatype, m_GlobalMesh );
+    // float halves the bytes through memcpy/MPI-IO/filesystem,
+    // opt back into double via  meshPrecision=double
+    if ( m_Input.m_DoubleMesh )
+      storeMeshData<double>(compA, step);
+    else
+      storeMeshData<float>(compA, step);
+  }
 
-    compA.resetDataset( dataset );
+  /*
+   * Write mesh data of the requested precision
+   *
+   *  @param T          mesh datatype (float or double)
+   *  (other parameters as storeMesh)
+   *
+   */
+  template<typename T>
+  void
+  AbstractPattern::storeMeshData(MeshRecordComponent& compA, int step)
+  {
+    compA.resetDataset( *m_MeshDataset );
+
+    // pre-stage all rank-local blocks back to back in one slab,
+    // in layout (=increasing file offset) order: one allocation
+    // and one contiguous source region per component
+    unsigned long totalSize = 0;
+    for ( const auto& block : m_InRankMeshLayout )
+      totalSize += countMe(block.second);
+    if (0 == totalSize)
+      return;
 
-    auto nBlocks = getNumBlocks();
+    T* slab = static_cast<T*>( g_CurrArena->alloc(totalSize * sizeof(T)) );
 
-    for ( unsigned int n=0; n<nBlocks; n++ )
+    T* curr = slab;
+    unsigned int n = 0;
+    for ( const auto& block : m_InRankMeshLayout )
       {
-        Extent meshExtent;
-        Offset meshOffset;
-        auto blockSize = getNthMeshExtent(n, meshOffset, meshExtent);
+        auto blockSize = countMe(block.second);
         if (blockSize > 0) {
-            auto const value = double(1.0*n + 0.01*step);
-            auto A = createData<double>( blockSize, value, 0.0001 ) ;
-            compA.storeChunk( A, meshOffset, meshExtent );
+            auto const value = T(1.0*n + 0.01*step);
+            fillSeries(curr, blockSize, value, T(0.0001));
+            compA.storeChunk( viewOf(curr), block.first, block.second );
+            curr += blockSize;
         }
+        n++;
       }
   }
 
@@ -665,15 +963,15 @@ void AbstractPattern::store(Series& series, int step)
     currSpecies.setAttribute( "openPMD_STEP", step );
     currSpecies.setAttribute( "p2mRatio", m_Input.m_Ratio );
 
-    auto np = getTotalNumParticles();
-    auto const intDataSet = openPMD::Dataset(openPMD::determineDatatype< uint64_t >(), {np});
-    auto const realDataSet = openPMD::Dataset(openPMD::determineDatatype< double >(), {np});
-    currSpecies["id"][RecordComponent::SCALAR].resetDataset( intDataSet );
-    currSpecies["charge"][RecordComponent::SCALAR].resetDataset( realDataSet );
+    RecordComponent& idComp = currSpecies["id"][RecordComponent::SCALAR];
+    RecordComponent& chargeComp = currSpecies["charge"][RecordComponent::SCALAR];
+    RecordComponent& mxComp = currSpecies["position"]["x"];
 
-    currSpecies["position"]["x"].resetDataset( realDataSet );
+    idComp.resetDataset( *m_ParticleIntDataset );
+    chargeComp.resetDataset( *m_ParticleRealDataset );
+    mxComp.resetDataset( *m_ParticleRealDataset );
 
-    currSpecies["positionOffset"]["x"].resetDataset( realDataSet );
+    currSpecies["positionOffset"]["x"].resetDataset( *m_ParticleRealDataset );
     currSpecies["positionOffset"]["x"].makeConstant( 0. );
 
     auto nBlocks = getNumBlocks();
@@ -684,17 +982,23 @@ void AbstractPattern::store(Series& series, int step)
         getNthParticleExtent(n, offset, count);
     //std::cout<<m_Input.m_MPIRank<<"... got p: "<<offset<<", "<<count<<std::endl;
         if (count > 0) {
-            auto ids = createData<uint64_t>( count, offset, 1 ) ;
-            currSpecies["id"][RecordComponent::SCALAR].storeChunk(ids, {offset}, {count});
-
-            auto charges = createData<double>(count, 0.1*step, 0.0001) ;
-            currSpecies["charge"][RecordComponent::SCALAR].storeChunk(charges,
-                                    {offset}, {count});
-
-            auto mx = createData<double>(count, 1.0*step, 0.0002) ;
-            currSpecies["position"]["x"].storeChunk(mx,
-                          {offset}, {count});
-
+            // one slab per block: ids/charges/positions live back to back,
+            // one allocation and three sequential fills instead of three
+            // separate buffers with interleaved setup
+            auto base = static_cast<uint8_t*>(
+                g_CurrArena->alloc( count * (sizeof(uint64_t) + 2*sizeof(double)) ) );
+
+            auto ids     = reinterpret_cast<uint64_t*>(base);
+            auto charges = reinterpret_cast<double*>(base + count*sizeof(uint64_t));
+            auto mx      = charges + count;
+
+            fillSeries(ids, count, offset, 1ul);
+            fillSeries(charges, count, 0.1*step, 0.0001);
+            fillSeries(mx, count, 1.0*step, 0.0002);
+
+            idComp.storeChunk( viewOf(ids), {offset}, {count} );
+            chargeComp.storeChunk( viewOf(charges), {offset}, {count} );
+            mxComp.storeChunk( viewOf(mx), {offset}, {count} );
     }
       }
   } // storeParticles
@@ -798,11 +1102,11 @@ OneDimPattern::OneDimPattern(const TestInput& input)
  */
 void TwoDimPattern::getNthParticleExtent( unsigned int n, unsigned long& offset, unsigned long& count )
   {
-    if (n > m_InRankMeshLayout.size())
+    if (n >= m_InRankParticleLayout.size())
       return;
 
-    offset = m_InRankParticleLayout[n].first;
-    count  = m_InRankParticleLayout[n].second;
+    offset = m_InRankParticleLayout.m_Offsets[n];
+    count  = m_InRankParticleLayout.m_Counts[n];
   }
 
 
@@ -814,11 +1118,11 @@ void TwoDimPattern::getNthParticleExtent( unsigned int n, unsigned long& offset,
  */
 void ThreeDimPattern::getNthParticleExtent( unsigned int n, unsigned long& offset, unsigned long& count )
   {
-    if (n > m_InRankMeshLayout.size())
+    if (n >= m_InRankParticleLayout.size())
       return;
 
-    offset = m_InRankParticleLayout[n].first;
-    count  = m_InRankParticleLayout[n].second;
+    offset = m_InRankParticleLayout.m_Offsets[n];
+    count  = m_InRankParticleLayout.m_Counts[n];
   }
 
 /*
@@ -872,6 +1176,7 @@ bool OneDimPattern::setLayOut(int step)
       }
     }
 
+    mergeBlocks();
     return true;
 }
 
@@ -885,7 +1190,7 @@ bool OneDimPattern::setLayOut(int step)
  */
 void OneDimPattern::getNthParticleExtent( unsigned int n, unsigned long& offset, unsigned long& count )
   {
-    if (n > m_InRankMeshLayout.size())
+    if (n >= m_InRankMeshLayout.size())
       return;
 
     offset = indexMe(m_InRankMeshLayout[n].first) * m_Input.m_Ratio;
@@ -992,7 +1297,7 @@ bool TwoDimPattern::setLayOut(int step)  {
          m_InRankMeshLayout.emplace_back(offset, count);
 
          auto pCount = countMe(count) * m_Input.m_Ratio;
-         m_InRankParticleLayout.emplace_back(pOff, pCount);
+         m_InRankParticleLayout.add(pOff, pCount);
       }
     else
       {
@@ -1011,15 +1316,93 @@ bool TwoDimPattern::setLayOut(int step)  {
                   m_InRankMeshLayout.emplace_back(currOff, currCount);
 
                   auto pCount = countMe(currCount) * m_Input.m_Ratio;
-                  m_InRankParticleLayout.emplace_back(counter, pCount);
+                  m_InRankParticleLayout.add(counter, pCount);
 
                   counter += pCount;
                }
     }
+
+    mergeBlocks();
     return true;
 }
 
 
+/* Merge adjacent blocks in a rank
+ *
+ *   neighbours along the last dimension become one storeChunk, then the
+ *   surviving strips merge along the remaining dimensions: a rank whose
+ *   miniblocks tile a rectangle ends up with a single contiguous block.
+ *   Particle blocks are merged in lockstep.
+ */
+void AbstractPattern::mergeBlocks()
+{
+  auto const ndim = m_GlobalMesh.size();
+  bool const withParticles = ( m_InRankParticleLayout.size() == m_InRankMeshLayout.size() );
+
+  // mesh blocks mergeable along dim d: equal in all other dims, adjacent in d
+  auto mergeable = [ndim](const std::pair<Offset, Extent>& prev,
+              const std::pair<Offset, Extent>& curr,
+              unsigned int d) -> bool
+  {
+    for ( unsigned int k=0; k<ndim; k++ )
+      {
+    if ( k == d )
+      continue;
+    if ( (prev.first[k] != curr.first[k]) || (prev.second[k] != curr.second[k]) )
+      return false;
+      }
+    return (prev.first[d] + prev.second[d]) == curr.first[d];
+  };
+
+  // one pass per dimension, innermost first: the scan order of setLayOut
+  // keeps merge candidates adjacent in the vector for every pass
+  for ( int dim = static_cast<int>(ndim) - 1; dim >= 0; dim-- )
+    {
+      if ( m_InRankMeshLayout.size() <= 1 )
+    break;
+
+      auto const d = static_cast<unsigned int>(dim);
+
+      std::vector<std::pair<Offset, Extent>> meshes;
+      ParticleLayout particles;
+
+      meshes.push_back( m_InRankMeshLayout[0] );
+      if (withParticles)
+    particles.add( m_InRankParticleLayout.m_Offsets[0], m_InRankParticleLayout.m_Counts[0] );
+
+      for ( unsigned int i=1; i<m_InRankMeshLayout.size(); i++ )
+    {
+      auto& prev = meshes.back();
+      const auto& curr = m_InRankMeshLayout[i];
+
+      bool canMerge = mergeable(prev, curr, d);
+      if ( canMerge && withParticles )
+        canMerge = ( particles.m_Offsets.back() + particles.m_Counts.back()
+             == m_InRankParticleLayout.m_Offsets[i] );
+
+      if ( canMerge )
+        {
+          prev.second[d] += curr.second[d];
+          if (withParticles)
+        particles.m_Counts.back() += m_InRankParticleLayout.m_Counts[i];
+        }
+      else
+        {
+          meshes.push_back(curr);
+          if (withParticles)
+        particles.add( m_InRankParticleLayout.m_Offsets[i], m_InRankParticleLayout.m_Counts[i] );
+        }
+    }
+
+      m_InRankMeshLayout.swap(meshes);
+      if (withParticles)
+    {
+      m_InRankParticleLayout.m_Offsets.swap(particles.m_Offsets);
+      m_InRankParticleLayout.m_Counts.swap(particles.m_Counts);
+    }
+    }
+}
+
 /* Returns num of blocks in a rank
  *
  */
@@ -1036,7 +1419,7 @@ unsigned int AbstractPattern::getNumBlocks()
  */
 unsigned long  AbstractPattern::getNthMeshExtent( unsigned int n, Offset& offset, Extent& count )
   {
-    if (n > m_InRankMeshLayout.size())
+    if (n >= m_InRankMeshLayout.size())
       return 0;
 
     offset = m_InRankMeshLayout[n].first;
@@ -1235,7 +1618,7 @@ bool ThreeDimPattern::setLayOut(int step)  {
     m_InRankMeshLayout.emplace_back(offset, count);
 
     auto pCount = countMe(count) * m_Input.m_Ratio;
-    m_InRankParticleLayout.emplace_back(pOff, pCount);
+    m_InRankParticleLayout.add(pOff, pCount);
       }
     else
       {
@@ -1256,12 +1639,13 @@ bool ThreeDimPattern::setLayOut(int step)  {
         m_InRankMeshLayout.emplace_back(currOff, currCount);
 
         auto pCount = countMe(currCount) * m_Input.m_Ratio;
-        m_InRankParticleLayout.emplace_back(counter, pCount);
+        m_InRankParticleLayout.add(counter, pCount);
 
         counter += pCount;
           }
       }
 
+    mergeBlocks();
     return true;
 }
 
@@ -277,6 +277,26 @@ public:
    * @param rho           a mesh
    *
    */
+  /*
+   * Load a mesh chunk with the datatype it was written in.
+   *   8a writes single precision meshes by default (meshPrecision=double
+   *   opts back into double) and loadChunk rejects float/double
+   *   mismatches, so the read side has to follow the file.
+   *
+   * @param comp        mesh component to read
+   * @param off         chunk offset
+   * @param ext         chunk extent
+   *
+   */
+  std::shared_ptr< void >
+  loadMeshChunk( MeshRecordComponent& comp, const Offset& off, const Extent& ext )
+  {
+    if ( comp.getDatatype() == determineDatatype< double >() )
+      return comp.loadChunk<double>(off, ext);
+
+    return comp.loadChunk<float>(off, ext);
+  }
+
   void
   fullscan( Series& series, MeshRecordComponent& rho )
   {
@@ -346,7 +366,7 @@ public:
     for (unsigned int i=0; i<grid.size(); i++)
       offset[i] *= count[i];
 
-    auto slice_data = rho.loadChunk<double>(offset, count);
+    auto slice_data = loadMeshChunk(rho, offset, count);
     series.flush();
   }
 
@@ -452,7 +472,7 @@ public:
 
     if ( (unsigned int) m_MPIRank < fractionOnDim)
       {
-        auto slice_data = rho.loadChunk<double>(off, ext);
+        auto slice_data = loadMeshChunk(rho, off, ext);
         series.flush();
 
         std::cout<<"Rank: "<<m_MPIRank;
@@ -538,7 +558,7 @@ public:
       return;
 
     Timer sliceTime(s.str(), m_MPIRank);
-    auto slice_data = rho.loadChunk<double>(off, ext);
+    auto slice_data = loadMeshChunk(rho, off, ext);
     series.flush();
   }
 
@@ -613,9 +633,9 @@ public:
       return;
 
     Timer sliceTime(s.str(), m_MPIRank);
-    auto bx_data = bx.loadChunk<double>(off, ext);
-    auto by_data = by.loadChunk<double>(off, ext);
-    auto bz_data = bz.loadChunk<double>(off, ext);
+    auto bx_data = loadMeshChunk(bx, off, ext);
+    auto by_data = loadMeshChunk(by, off, ext);
+    auto bz_data = loadMeshChunk(bz, off, ext);
 
     series.flush();
 
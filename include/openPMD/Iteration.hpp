@@ -20,11 +20,14 @@
  */
 #pragma once
 
+#include "openPMD/auxiliary/Option.hpp"
 #include "openPMD/backend/Attributable.hpp"
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/Mesh.hpp"
 #include "openPMD/ParticleSpecies.hpp"
 
+#include <memory>
+
 
 namespace openPMD
 {
@@ -128,8 +131,8 @@ public:
     bool
     closedByWriter() const;
 
-    Container< Mesh > meshes;
-    Container< ParticleSpecies > particles; //particleSpecies?
+    FlatContainer< Mesh > meshes;
+    FlatContainer< ParticleSpecies > particles; //particleSpecies?
 
     virtual ~Iteration() = default;
 private:
@@ -164,6 +167,20 @@ private:
     std::shared_ptr< CloseStatus > m_closed =
         std::make_shared< CloseStatus >( CloseStatus::Open );
 
+    /*
+     * Cache for the time and dt attributes, i.e. the values most commonly
+     * queried once per iteration when stepping through a series.
+     * A hit skips the string-keyed attribute lookup; the cached Attribute
+     * preserves the exact conversion semantics of getAttribute().get< T >().
+     * Shared between handle copies (cf. m_closed), so a setTime()/setDt()
+     * through any copy refreshes all of them; generic setAttribute() and
+     * deleteAttribute() calls drop the cache via invalidateAttributeCache().
+     */
+    std::shared_ptr< auxiliary::Option< Attribute > > m_cachedTime =
+        std::make_shared< auxiliary::Option< Attribute > >();
+    std::shared_ptr< auxiliary::Option< Attribute > > m_cachedDt =
+        std::make_shared< auxiliary::Option< Attribute > >();
+
     /*
      * @brief Check recursively whether this Iteration is dirty.
      *        It is dirty if any attribute or dataset is read from or written to
@@ -176,6 +193,8 @@ private:
     dirtyRecursive() const;
 
     virtual void linkHierarchy(std::shared_ptr< Writable > const& w);
+
+    void invalidateAttributeCache(std::string const& key) override;
 };  // Iteration
 
 extern template
@@ -193,7 +212,13 @@ Iteration::time< long double >() const;
 template< typename T >
 inline T
 Iteration::time() const
-{ return Attributable::readFloatingpoint< T >("time"); }
+{
+    static_assert(std::is_floating_point< T >::value, "Type of attribute must be floating point");
+
+    if( !m_cachedTime->has_value() )
+        *m_cachedTime = auxiliary::makeOption( getAttribute("time") );
+    return m_cachedTime->get().get< T >();
+}
 
 
 extern template
@@ -211,5 +236,11 @@ Iteration::dt< long double >() const;
 template< typename T >
 inline T
 Iteration::dt() const
-{ return Attributable::readFloatingpoint< T >("dt"); }
+{
+    static_assert(std::is_floating_point< T >::value, "Type of attribute must be floating point");
+
+    if( !m_cachedDt->has_value() )
+        *m_cachedDt = auxiliary::makeOption( getAttribute("dt") );
+    return m_cachedDt->get().get< T >();
+}
 } // openPMD
@@ -38,7 +38,12 @@ namespace openPMD
  */
 class Mesh : public BaseRecord< MeshRecordComponent >
 {
-    friend class Container< Mesh >;
+    template<
+            typename T,
+            typename T_key,
+            typename T_container
+    >
+    friend class Container;
     friend class Iteration;
 
 public:
@@ -33,8 +33,12 @@ namespace openPMD
 
 class ParticleSpecies : public Container< Record >
 {
-    friend class Container< ParticleSpecies >;
-    friend class Container< Record >;
+    template<
+            typename T,
+            typename T_key,
+            typename T_container
+    >
+    friend class Container;
     friend class Iteration;
 
 public:
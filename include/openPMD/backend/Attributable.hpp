@@ -155,6 +155,15 @@ OPENPMD_protected:
     void flushAttributes();
     void readAttributes();
 
+    /** Hook for subclasses that cache values derived from attributes.
+     *
+     * Invoked for every write to or removal of an Attribute, including
+     * generic setAttribute() calls that bypass a subclass' typed setters.
+     *
+     * @param   key Key (i.e. name) of the written or removed Attribute.
+     */
+    virtual void invalidateAttributeCache(std::string const& /* key */) { }
+
     /** Retrieve the value of a floating point Attribute of user-defined precision with ensured type-safety.
      *
      * @note    Since the precision of certain Attributes is intentionally left
@@ -223,12 +232,14 @@ Attributable::setAttribute(std::string const& key, T const& value)
     {
         // key already exists in map, just replace the value
         it->second = Attribute(value);
+        invalidateAttributeCache(key);
         return true;
     } else
     {
         // emplace a new map element for an unknown key
         m_attributes->emplace_hint(it,
                                    std::make_pair(key, Attribute(value)));
+        invalidateAttributeCache(key);
         return false;
     }
 }
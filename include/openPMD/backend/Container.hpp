@@ -27,6 +27,7 @@
 #include <stdexcept>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 // expose private and protected members for invasive testing
 #ifndef OPENPMD_protected
@@ -281,4 +282,22 @@ OPENPMD_protected:
     std::shared_ptr< InternalContainer > m_container;
 };
 
+/** Hash-map backed Container for small, lookup-dominated collections.
+ *
+ * Meshes and particle species hold a handful of entries but are looked up
+ * by name over and over in hot write loops; std::unordered_map resolves a
+ * lookup with one hash of the key instead of the repeated string
+ * comparisons a std::map traversal performs, and never rebalances.
+ * Inserts still allocate one node per entry, as in std::map.
+ *
+ * @attention Iteration order over such a container is unspecified instead
+ *            of sorted by key.
+ */
+template< typename T >
+using FlatContainer = Container<
+    T,
+    std::string,
+    std::unordered_map< std::string, T >
+>;
+
 } // openPMD
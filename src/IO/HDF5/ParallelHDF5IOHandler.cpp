@@ -83,6 +83,22 @@ ParallelHDF5IOHandlerImpl::ParallelHDF5IOHandlerImpl(AbstractIOHandler* handler,
          H5Pset_alignment(m_fileAccessProperty, 0, bytes);
 
     VERIFY(status >= 0, "[HDF5] Internal error: Failed to set HDF5 dataset transfer property");
+
+#if H5_VERSION_GE(1,10,0)
+    auto const hdf5_collective_metadata = auxiliary::getEnvString( "OPENPMD_HDF5_COLLECTIVE_METADATA", "ON" );
+    if( hdf5_collective_metadata == "ON" )
+    {
+        status = H5Pset_all_coll_metadata_ops(m_fileAccessProperty, 1);
+        VERIFY(status >= 0, "[HDF5] Internal error: Failed to set collective metadata reads");
+        status = H5Pset_coll_metadata_write(m_fileAccessProperty, 1);
+        VERIFY(status >= 0, "[HDF5] Internal error: Failed to set collective metadata writes");
+    }
+    else
+    {
+        VERIFY(hdf5_collective_metadata == "OFF", "[HDF5] Internal error: OPENPMD_HDF5_COLLECTIVE_METADATA property must be either ON or OFF");
+    }
+#endif
+
     status = H5Pset_fapl_mpio(m_fileAccessProperty, m_mpiComm, m_mpiInfo);
     VERIFY(status >= 0, "[HDF5] Internal error: Failed to set HDF5 file access property");
 }
@@ -34,8 +34,8 @@
 namespace openPMD
 {
 Iteration::Iteration()
-        : meshes{Container< Mesh >()},
-          particles{Container< ParticleSpecies >()}
+        : meshes{FlatContainer< Mesh >()},
+          particles{FlatContainer< ParticleSpecies >()}
 {
     setTime(static_cast< double >(0));
     setDt(static_cast< double >(1));
@@ -46,7 +46,9 @@ Iteration::Iteration(Iteration const& i)
         : Attributable{i},
           meshes{i.meshes},
           particles{i.particles},
-          m_closed{i.m_closed}
+          m_closed{i.m_closed},
+          m_cachedTime{i.m_cachedTime},
+          m_cachedDt{i.m_cachedDt}
 {
     IOHandler = i.IOHandler;
     parent = i.parent;
@@ -65,6 +67,8 @@ Iteration& Iteration::operator=(Iteration const& i)
     IOHandler = i.IOHandler;
     parent = i.parent;
     m_closed = i.m_closed;
+    m_cachedTime = i.m_cachedTime;
+    m_cachedDt = i.m_cachedDt;
     meshes.IOHandler = IOHandler;
     meshes.parent = this->m_writable.get();
     particles.IOHandler = IOHandler;
@@ -79,6 +83,7 @@ Iteration::setTime(T newTime)
     static_assert(std::is_floating_point< T >::value, "Type of attribute must be floating point");
 
     setAttribute("time", newTime);
+    *m_cachedTime = auxiliary::makeOption( Attribute(newTime) );
     return *this;
 }
 
@@ -89,9 +94,19 @@ Iteration::setDt(T newDt)
     static_assert(std::is_floating_point< T >::value, "Type of attribute must be floating point");
 
     setAttribute("dt", newDt);
+    *m_cachedDt = auxiliary::makeOption( Attribute(newDt) );
     return *this;
 }
 
+void
+Iteration::invalidateAttributeCache(std::string const& key)
+{
+    if( "time" == key )
+        *m_cachedTime = auxiliary::Option< Attribute >();
+    else if( "dt" == key )
+        *m_cachedDt = auxiliary::Option< Attribute >();
+}
+
 double
 Iteration::timeUnitSI() const
 {
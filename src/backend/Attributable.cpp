@@ -82,6 +82,7 @@ Attributable::deleteAttribute(std::string const& key)
         IOHandler->enqueue(IOTask(this, aDelete));
         IOHandler->flush();
         m_attributes->erase(it);
+        invalidateAttributeCache(key);
         return true;
     }
     return false;
@@ -205,8 +205,8 @@ using PyIterationContainer = Container<
     Iteration,
     uint64_t
 >;
-using PyMeshContainer = Container< Mesh >;
-using PyPartContainer = Container< ParticleSpecies >;
+using PyMeshContainer = FlatContainer< Mesh >;
+using PyPartContainer = FlatContainer< ParticleSpecies >;
 using PyPatchContainer = Container< ParticlePatches >;
 using PyRecordContainer = Container< Record >;
 using PyPatchRecordContainer = Container< PatchRecord >;
@@ -246,6 +246,25 @@ TEST_CASE( "iteration_modification_test", "[core]" )
     REQUIRE(i.timeUnitSI() == static_cast< double >(0.000000000001));
 }
 
+TEST_CASE( "iteration_attribute_cache_test", "[core]" )
+{
+    Series o = Series("./MyOutput_%T.json", Access::CREATE);
+
+    Iteration& i = o.iterations[42];
+
+    /* canonical setters refresh the cached time/dt */
+    i.setTime(0.1234);
+    REQUIRE(i.time< double >() == 0.1234);
+    i.setDt(0.5);
+    REQUIRE(i.dt< double >() == 0.5);
+
+    /* generic attribute writes must invalidate the cache, too */
+    i.setAttribute("time", 1.25);
+    REQUIRE(i.time< double >() == 1.25);
+    i.setAttribute("dt", 2.5);
+    REQUIRE(i.dt< double >() == 2.5);
+}
+
 TEST_CASE( "particleSpecies_modification_test", "[core]" )
 {
     Series o = Series("./MyOutput_%T.json", Access::CREATE);